@@ -0,0 +1,108 @@
+/**\file
+ * \brief Booking abstraction
+ *
+ * Contains templates that provide access to bookings in Verthandi's database. A
+ * booking is a single entry in the 'bookings' table.
+ *
+ * \copyright
+ * Copyright (c) 2013-2014, Verthandi Project Members
+ * \copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * \copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * \copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \see Project Documentation: http://ef.gy/documentation/verthandi
+ * \see Project Source Code: http://github.com/machinelady/verthandi.git
+ */
+
+#if !defined(VERTHANDI_BOOKING_H)
+#define VERTHANDI_BOOKING_H
+
+#include <ef.gy/maybe.h>
+
+#include <verthandi/schema.h>
+
+#include <string>
+
+namespace verthandi
+{
+    /**\brief A booking
+     *
+     * Contains a single row of the 'bookings' table in the database, i.e. a
+     * span of time that was spent working on a task. The row is identified by a
+     * numeric ID and its columns are described by fields(), which is why this
+     * class derives from the verthandi::schema::entity template.
+     *
+     * \tparam db The database access class to use, e.g. efgy::database::sqlite
+     */
+    template <typename db>
+    class booking : public schema::entity<db,booking<db>>
+    {
+        public:
+            /**\copydoc object<db>::object
+             *
+             * In instances of the booking type, the pID is assumed to refer to
+             * the contents of the bookings.id column, and the corresponding row
+             * is automatically retrieved when an instance of the class is
+             * initialised.
+             */
+            booking (db &pDatabase, const typename db::id &pID)
+                : schema::entity<db,booking<db>>(pDatabase, pID) { this->sync(); }
+
+            /**\brief Start time
+             *
+             * Corresponds to the bookings.start_time field in the database.
+             */
+            efgy::maybe<double> startTime;
+
+            /**\brief End time
+             *
+             * Corresponds to the bookings.end_time field in the database.
+             */
+            efgy::maybe<double> endTime;
+
+            /**\brief Database table
+             *
+             * \returns The name of the table that bookings are stored in.
+             */
+            static const char *table (void) { return "bookings"; }
+
+            /**\brief XML element
+             *
+             * \returns The name of the XML element for a booking.
+             */
+            static const char *element (void) { return "booking"; }
+
+            /**\brief Field description
+             *
+             * Describes the columns of the 'bookings' table that are mapped to
+             * fields of this class; see verthandi::schema.
+             *
+             * \tparam F Type of the visitor.
+             *
+             * \param[out] f The visitor to call for each field.
+             */
+            template <typename F>
+            static void fields (F &f)
+            {
+                f.attribute("start_time", "start_time", &booking::startTime);
+                f.attribute("end_time",   "end_time",   &booking::endTime);
+            }
+    };
+};
+
+#endif
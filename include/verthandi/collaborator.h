@@ -0,0 +1,140 @@
+/**\file
+ * \brief Collaborator abstraction
+ *
+ * Contains templates that provide access to collaborators in Verthandi's
+ * database. A collaborator is a single entry in the 'collaborators' table.
+ *
+ * \copyright
+ * Copyright (c) 2013-2014, Verthandi Project Members
+ * \copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * \copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * \copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \see Project Documentation: http://ef.gy/documentation/verthandi
+ * \see Project Source Code: http://github.com/machinelady/verthandi.git
+ */
+
+#if !defined(VERTHANDI_COLLABORATOR_H)
+#define VERTHANDI_COLLABORATOR_H
+
+#include <ef.gy/maybe.h>
+
+#include <verthandi/schema.h>
+
+#include <string>
+
+namespace verthandi
+{
+    /**\brief A collaborator
+     *
+     * Contains a single row of the 'collaborators' table in the database, i.e.
+     * a person who works on tasks. The row is identified by a numeric ID and
+     * its columns are described by fields(), which is why this class derives
+     * from the verthandi::schema::entity template.
+     *
+     * \tparam db The database access class to use, e.g. efgy::database::sqlite
+     */
+    template <typename db>
+    class collaborator : public schema::entity<db,collaborator<db>>
+    {
+        public:
+            /**\copydoc object<db>::object
+             *
+             * In instances of the collaborator type, the pID is assumed to
+             * refer to the contents of the collaborators.id column, and the
+             * corresponding row is automatically retrieved when an instance of
+             * the class is initialised.
+             */
+            collaborator (db &pDatabase, const typename db::id &pID)
+                : schema::entity<db,collaborator<db>>(pDatabase, pID) { this->sync(); }
+
+            /**\brief First name
+             *
+             * Corresponds to the collaborators.first_name field in the
+             * database. This is optional, as not all cultures have first and
+             * last names.
+             */
+            efgy::maybe<std::string> firstName;
+
+            /**\brief Last name
+             *
+             * Corresponds to the collaborators.last_name field in the database.
+             */
+            std::string lastName;
+
+            /**\brief Email address
+             *
+             * Corresponds to the collaborators.email field in the database.
+             */
+            efgy::maybe<std::string> email;
+
+            /**\brief Phone number
+             *
+             * Corresponds to the collaborators.phone field in the database.
+             */
+            efgy::maybe<std::string> phone;
+
+            /**\brief Form of address
+             *
+             * Corresponds to the collaborators.form_of_address field in the
+             * database.
+             */
+            efgy::maybe<std::string> formOfAddress;
+
+            /**\brief Preferred pronoun
+             *
+             * Corresponds to the collaborators.preferred_pronoun field in the
+             * database.
+             */
+            efgy::maybe<std::string> preferredPronoun;
+
+            /**\brief Database table
+             *
+             * \returns The name of the table that collaborators are stored in.
+             */
+            static const char *table (void) { return "collaborators"; }
+
+            /**\brief XML element
+             *
+             * \returns The name of the XML element for a collaborator.
+             */
+            static const char *element (void) { return "collaborator"; }
+
+            /**\brief Field description
+             *
+             * Describes the columns of the 'collaborators' table that are
+             * mapped to fields of this class; see verthandi::schema.
+             *
+             * \tparam F Type of the visitor.
+             *
+             * \param[out] f The visitor to call for each field.
+             */
+            template <typename F>
+            static void fields (F &f)
+            {
+                f.attribute("first_name",        "first_name",        &collaborator::firstName);
+                f.attribute("last_name",         "last_name",         &collaborator::lastName);
+                f.attribute("email",             "email",             &collaborator::email);
+                f.attribute("phone",             "phone",             &collaborator::phone);
+                f.attribute("form_of_address",   "form_of_address",   &collaborator::formOfAddress);
+                f.attribute("preferred_pronoun", "preferred_pronoun", &collaborator::preferredPronoun);
+            }
+    };
+};
+
+#endif
@@ -0,0 +1,134 @@
+/**\file
+ * \brief Customer abstraction
+ *
+ * Contains templates that provide access to customers in Verthandi's database.
+ * A customer is a single entry in the 'customers' table.
+ *
+ * \copyright
+ * Copyright (c) 2013-2014, Verthandi Project Members
+ * \copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * \copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * \copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \see Project Documentation: http://ef.gy/documentation/verthandi
+ * \see Project Source Code: http://github.com/machinelady/verthandi.git
+ */
+
+#if !defined(VERTHANDI_CUSTOMER_H)
+#define VERTHANDI_CUSTOMER_H
+
+#include <ef.gy/maybe.h>
+
+#include <verthandi/schema.h>
+
+#include <string>
+
+namespace verthandi
+{
+    /**\brief A customer
+     *
+     * Contains a single row of the 'customers' table in the database. Projects
+     * refer to customers through the projects.customer column. The row is
+     * identified by a numeric ID and its columns are described by fields(),
+     * which is why this class derives from the verthandi::schema::entity
+     * template.
+     *
+     * \tparam db The database access class to use, e.g. efgy::database::sqlite
+     */
+    template <typename db>
+    class customer : public schema::entity<db,customer<db>>
+    {
+        public:
+            /**\copydoc object<db>::object
+             *
+             * In instances of the customer type, the pID is assumed to refer to
+             * the contents of the customers.id column, and the corresponding
+             * row is automatically retrieved when an instance of the class is
+             * initialised.
+             */
+            customer (db &pDatabase, const typename db::id &pID)
+                : schema::entity<db,customer<db>>(pDatabase, pID) { this->sync(); }
+
+            /**\brief Customer name
+             *
+             * Corresponds to the customers.name field in the database.
+             */
+            std::string name;
+
+            /**\brief Primary contact
+             *
+             * Corresponds to the customers.primary_contact field in the
+             * database. This is the name of the person to talk to at the
+             * customer.
+             */
+            efgy::maybe<std::string> primaryContact;
+
+            /**\brief Primary contact's email address
+             *
+             * Corresponds to the customers.primary_contact_email field in the
+             * database.
+             */
+            efgy::maybe<std::string> primaryContactEmail;
+
+            /**\brief Primary contact's phone number
+             *
+             * Corresponds to the customers.primary_contact_phone field in the
+             * database.
+             */
+            efgy::maybe<std::string> primaryContactPhone;
+
+            /**\brief Notes
+             *
+             * Corresponds to the customers.notes field in the database.
+             */
+            efgy::maybe<std::string> notes;
+
+            /**\brief Database table
+             *
+             * \returns The name of the table that customers are stored in.
+             */
+            static const char *table (void) { return "customers"; }
+
+            /**\brief XML element
+             *
+             * \returns The name of the XML element for a customer.
+             */
+            static const char *element (void) { return "customer"; }
+
+            /**\brief Field description
+             *
+             * Describes the columns of the 'customers' table that are mapped to
+             * fields of this class; see verthandi::schema.
+             *
+             * \tparam F Type of the visitor.
+             *
+             * \param[out] f The visitor to call for each field.
+             */
+            template <typename F>
+            static void fields (F &f)
+            {
+                f.attribute("name",                  "name",                  &customer::name);
+                f.attribute("primary_contact",       "primary_contact",       &customer::primaryContact);
+                f.attribute("primary_contact_email", "primary_contact_email", &customer::primaryContactEmail);
+                f.attribute("primary_contact_phone", "primary_contact_phone", &customer::primaryContactPhone);
+                f.content  ("notes",                                          &customer::notes);
+            }
+    };
+};
+
+#endif
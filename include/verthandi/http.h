@@ -120,31 +120,9 @@ namespace verthandi
 
                     static const std::regex rproject("/verthandi/project/(\\d+)");
                     static const std::regex rtask("/verthandi/task/(\\d+)");
-                    std::smatch matches;
 
-                    if (std::regex_match(a.resource, matches, rproject))
-                    {
-                        int projectID = 0;
-                        std::stringstream is(matches[1]);
-                        is >> projectID;
-
-                        s << "<?xml version='1.0' encoding='utf-8'?>"
-                             "<verthandi xmlns='http://verthandi.org/2014/verthandi'>";
-                        s << efgy::render::XML() << project<db>(a.state->sql, projectID);
-                        s << "</verthandi>";
-                    }
-                    else if (std::regex_match(a.resource, matches, rtask))
-                    {
-                        int taskID = 0;
-                        std::stringstream is(matches[1]);
-                        is >> taskID;
-
-                        s << "<?xml version='1.0' encoding='utf-8'?>"
-                             "<verthandi xmlns='http://verthandi.org/2014/verthandi'>";
-                        s << efgy::render::XML() << task<db>(a.state->sql, taskID);
-                        s << "</verthandi>";
-                    }
-                    else
+                    if (!(   render<project>(a, rproject, s)
+                          || render<task>   (a, rtask,    s)))
                     {
                         s << "<?xml version='1.0' encoding='utf-8'?>"
                              "<verthandi xmlns='http://verthandi.org/2014/verthandi'>"
@@ -154,6 +132,46 @@ namespace verthandi
 
                     a.reply (200, "Content-Type: text/xml; charset=utf-8\r\n", s.str());
 
+                    return true;
+                }
+
+            protected:
+                /**\brief Render database object
+                 *
+                 * Checks whether the requested resource matches the given
+                 * regular expression and, if so, writes the XML representation
+                 * of the object of type T<db> with the ID given in the first
+                 * submatch.
+                 *
+                 * \tparam T The class template of the object to render, e.g.
+                 *           verthandi::project
+                 *
+                 * \param[in]  a Data for the current request.
+                 * \param[in]  r Regular expression for the resource.
+                 * \param[out] s The stream to write the reply to.
+                 *
+                 * \returns 'true' if the resource matched and a reply was
+                 *          written, 'false' otherwise.
+                 */
+                template <template <typename> class T>
+                static bool render (session &a, const std::regex &r, std::ostream &s)
+                {
+                    std::smatch matches;
+
+                    if (!std::regex_match(a.resource, matches, r))
+                    {
+                        return false;
+                    }
+
+                    typename db::id objectID = 0;
+                    std::stringstream is(matches[1]);
+                    is >> objectID;
+
+                    s << "<?xml version='1.0' encoding='utf-8'?>"
+                         "<verthandi xmlns='http://verthandi.org/2014/verthandi'>";
+                    s << efgy::render::XML() << T<db>(a.state->sql, objectID);
+                    s << "</verthandi>";
+
                     return true;
                 }
         };
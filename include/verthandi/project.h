@@ -32,12 +32,10 @@
 #if !defined(VERTHANDI_PROJECT_H)
 #define VERTHANDI_PROJECT_H
 
-#include <ef.gy/render-xml.h>
 #include <ef.gy/maybe.h>
 
-#include <verthandi/object.h>
+#include <verthandi/schema.h>
 
-#include <ostream>
 #include <string>
 
 namespace verthandi
@@ -45,24 +43,25 @@ namespace verthandi
     /**\brief A project
      *
      * Contains a single row of the 'projects' table in the database. The row is
-     * identified by a numeric ID, which is why this class derives from the
-     * verthandi::object template.
+     * identified by a numeric ID and its columns are described by fields(),
+     * which is why this class derives from the verthandi::schema::entity
+     * template.
      *
      * \tparam db The database access class to use, e.g. efgy::database::sqlite
      */
     template <typename db>
-    class project : public object<db>
+    class project : public schema::entity<db,project<db>>
     {
         public:
             /**\copydoc object<db>::object
              *
-             * In instances of the task type, the pID is assumed to refer to the
-             * contents of the tasks.id column, and the corresponding row is
-             * automatically retrieved when an instance of the class is
+             * In instances of the project type, the pID is assumed to refer to
+             * the contents of the projects.id column, and the corresponding row
+             * is automatically retrieved when an instance of the class is
              * initialised.
              */
             project (db &pDatabase, const typename db::id &pID)
-                : object<db>(pDatabase, pID) { sync(); }
+                : schema::entity<db,project<db>>(pDatabase, pID) { this->sync(); }
 
             /**\brief Project name
              *
@@ -70,88 +69,69 @@ namespace verthandi
              */
             std::string name;
 
+            /**\brief Project description
+             *
+             * Corresponds to the projects.description field in the database.
+             */
             efgy::maybe<std::string> description;
+
+            /**\brief Customer
+             *
+             * Corresponds to the projects.customer field in the database. This
+             * is the ID of a row in the 'customers' table.
+             */
+            efgy::maybe<typename db::id> customerID;
+
+            /**\brief Deadline
+             *
+             * Corresponds to the projects.deadline field in the database.
+             */
             efgy::maybe<double> deadline;
+
+            /**\brief Urgency
+             *
+             * Corresponds to the projects.urgency field in the database.
+             */
             efgy::maybe<int> urgency;
+
+            /**\brief Importance
+             *
+             * Corresponds to the projects.importance field in the database.
+             */
             efgy::maybe<int> importance;
 
-            using object<db>::id;
-            using object<db>::valid;
+            /**\brief Database table
+             *
+             * \returns The name of the table that projects are stored in.
+             */
+            static const char *table (void) { return "projects"; }
 
-        protected:
-            using object<db>::database;
+            /**\brief XML element
+             *
+             * \returns The name of the XML element for a project.
+             */
+            static const char *element (void) { return "project"; }
 
-            /**\brief Retrieve project data from database
+            /**\brief Field description
              *
-             * Selects the project's data from the database and stores the data
-             * in the class instance.
+             * Describes the columns of the 'projects' table that are mapped to
+             * fields of this class; see verthandi::schema.
              *
-             * \returns 'true' if the project instance is now in a valid state,
-             *          false otherwise.
+             * \tparam F Type of the visitor.
+             *
+             * \param[out] f The visitor to call for each field.
              */
-            bool sync (void)
+            template <typename F>
+            static void fields (F &f)
             {
-                typename db::statement select("select name, description, deadline, urgency, importance from projects where id=?1", database);
-                select.bind(1, id);
-                if (select.step() && select.row)
-                {
-                    select.get(0, name);
-                    description.nothing = !select.get(1, description.just);
-                    deadline.nothing    = !select.get(2, deadline.just);
-                    urgency.nothing     = !select.get(3, urgency.just);
-                    importance.nothing  = !select.get(4, importance.just);
-                    return (valid = true);
-                }
-                return (valid = false);
+                f.attribute("name",        "name",        &project::name);
+                f.content  ("description",                &project::description);
+                f.attribute("customer",    "customer",    &project::customerID);
+                f.attribute("deadline",    "deadline",    &project::deadline);
+                f.attribute("urgency",     "urgency",     &project::urgency);
+                f.attribute("importance",  "importance",  &project::importance);
             }
     };
-
-    /**\brief Serialise project to stream
-     *
-     * Writes an XML representation of a project to a C++ stream object.
-     *
-     * \tparam C  Character type of the stream.
-     * \tparam db Database type of the task instance.
-     *
-     * \param[out] out The stream to write to.
-     * \param[in]  p   The task instance to write to the stream.
-     *
-     * \returns A reference to the 'out' parameter, as is customary with C++
-     *          streams.
-     */
-    template <typename C, typename db>
-    efgy::render::oxmlstream<C> operator << (efgy::render::oxmlstream<C> out, const project<db> &p)
-    {
-        if (!p.valid)
-        {
-            out.stream << "<project id='" << p.id << "' status='invalid'/>";
-        }
-        else
-        {
-            out.stream << "<project id='" << p.id << "' name='" << p.name << "'";
-            if (p.deadline)
-            {
-                out.stream << " deadline='" << p.deadline.just << "'";
-            }
-            if (p.urgency)
-            {
-                out.stream << " urgency='" << p.urgency.just << "'";
-            }
-            if (p.importance)
-            {
-                out.stream << " importance='" << p.importance.just << "'";
-            }
-            if (p.description)
-            {
-                out.stream << ">" << p.description.just << "</project>";
-            }
-            else
-            {
-                out.stream << "/>";
-            }
-        }
-        return out;
-    }
 };
 
 #endif
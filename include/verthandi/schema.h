@@ -0,0 +1,613 @@
+/**\file
+ * \brief Declarative row mapping
+ *
+ * Contains templates that generate the SQL, the column binding and the XML
+ * serialisation of database objects from a single, compile-time description of
+ * their fields.
+ *
+ * \copyright
+ * Copyright (c) 2013-2014, Verthandi Project Members
+ * \copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * \copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * \copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \see Project Documentation: http://ef.gy/documentation/verthandi
+ * \see Project Source Code: http://github.com/machinelady/verthandi.git
+ */
+
+#if !defined(VERTHANDI_SCHEMA_H)
+#define VERTHANDI_SCHEMA_H
+
+#include <ef.gy/render-xml.h>
+#include <ef.gy/maybe.h>
+
+#include <verthandi/object.h>
+
+#include <string>
+
+namespace verthandi
+{
+    /**\brief Declarative row mapping
+     *
+     * Database objects describe their columns with a static fields() template
+     * that calls attribute() or content() on a visitor with a pointer to the
+     * member for each column, in the order in which the columns appear in the
+     * generated SELECT. The visitors in this namespace then generate the
+     * column list, fill in a row and write the XML representation of an
+     * object. Which overload handles a field - e.g. whether the column may be
+     * NULL - is decided at compile time, from the type of the member.
+     *
+     * A class T that is to be used with these templates derives from
+     * schema::entity<db,T> and provides:
+     *   - static const char *table(void), the name of the table,
+     *   - static const char *element(void), the name of the XML element,
+     *   - template <typename F> static void fields(F &f), the field
+     *     description itself.
+     */
+    namespace schema
+    {
+        /**\brief Column list visitor
+         *
+         * Collects the names of all of the columns of a class, separated by
+         * commas, in the order given by the field description.
+         */
+        class columns
+        {
+            public:
+                /**\brief Column list
+                 *
+                 * The comma-separated column list, e.g. "name, description".
+                 */
+                std::string list;
+
+                /**\brief Visit attribute field
+                 *
+                 * Appends the field's column to the list.
+                 *
+                 * \tparam T Class that the field belongs to.
+                 * \tparam V Type of the field.
+                 *
+                 * \param[in] column Name of the field's column.
+                 */
+                template <typename T, typename V>
+                void attribute (const char *column, const char *, V T::*)
+                {
+                    add(column);
+                }
+
+                /**\brief Visit content field
+                 *
+                 * Appends the field's column to the list.
+                 *
+                 * \tparam T Class that the field belongs to.
+                 * \tparam V Type of the field.
+                 *
+                 * \param[in] column Name of the field's column.
+                 */
+                template <typename T, typename V>
+                void content (const char *column, V T::*)
+                {
+                    add(column);
+                }
+
+            protected:
+                /**\brief Append column
+                 *
+                 * Appends a single column name to the list.
+                 *
+                 * \param[in] column The name of the column to add.
+                 */
+                void add (const char *column)
+                {
+                    if (!list.empty())
+                    {
+                        list += ", ";
+                    }
+                    list += column;
+                }
+        };
+
+        /**\brief Row visitor
+         *
+         * Copies the columns of the current row of a statement into the fields
+         * of an object. The column index is advanced with every field, so the
+         * fields are read in the same order as the column list produced by
+         * the 'columns' visitor.
+         *
+         * \tparam db The database access class to use, e.g.
+         *            efgy::database::sqlite
+         * \tparam T  The class of the object to fill in.
+         */
+        template <typename db, typename T>
+        class row
+        {
+            public:
+                /**\brief Construct with statement and object
+                 *
+                 * Binds the visitor to a statement that has just returned a
+                 * row and to the object that the row is copied to.
+                 *
+                 * \param[in]  pStatement The statement to read columns from.
+                 * \param[out] pObject    The object to write fields to.
+                 */
+                row (typename db::statement &pStatement, T &pObject)
+                    : statement(pStatement), object(pObject), index(0) {}
+
+                /**\brief Visit attribute field
+                 *
+                 * Reads the next column of the row into the field.
+                 *
+                 * \tparam V Type of the field.
+                 *
+                 * \param[in] member The field to read into.
+                 */
+                template <typename V>
+                void attribute (const char *, const char *, V T::*member)
+                {
+                    get(object.*member);
+                }
+
+                /**\brief Visit content field
+                 *
+                 * Reads the next column of the row into the field.
+                 *
+                 * \tparam V Type of the field.
+                 *
+                 * \param[in] member The field to read into.
+                 */
+                template <typename V>
+                void content (const char *, V T::*member)
+                {
+                    get(object.*member);
+                }
+
+            protected:
+                /**\brief Statement to read from
+                 *
+                 * The statement that was passed to the constructor.
+                 */
+                typename db::statement &statement;
+
+                /**\brief Object to write to
+                 *
+                 * The object that was passed to the constructor.
+                 */
+                T &object;
+
+                /**\brief Current column
+                 *
+                 * Index of the column that the next field is read from.
+                 */
+                int index;
+
+                /**\brief Read mandatory column
+                 *
+                 * Reads a column that is declared 'not null' in the database.
+                 *
+                 * \param[out] value Where to store the column's value.
+                 */
+                template <typename V>
+                void get (V &value)
+                {
+                    statement.get(index++, value);
+                }
+
+                /**\brief Read boolean column
+                 *
+                 * Reads an integer column and stores whether it is nonzero.
+                 *
+                 * \param[out] value Where to store the column's value.
+                 */
+                void get (bool &value)
+                {
+                    int v = 0;
+                    statement.get(index++, v);
+                    value = (v != 0);
+                }
+
+                /**\brief Read optional column
+                 *
+                 * Reads a column that may be NULL in the database; the
+                 * 'nothing' flag of the value is set if the column was NULL.
+                 * Partial ordering prefers this overload over the generic one
+                 * for all efgy::maybe fields.
+                 *
+                 * \param[out] value Where to store the column's value.
+                 */
+                template <typename V>
+                void get (efgy::maybe<V> &value)
+                {
+                    value.nothing = !statement.get(index++, value.just);
+                }
+        };
+
+        /**\brief XML attribute visitor
+         *
+         * Writes all of the attribute fields of an object that have a value as
+         * XML attributes; content fields are skipped.
+         *
+         * \tparam C Character type of the stream.
+         * \tparam T The class of the object to write.
+         */
+        template <typename C, typename T>
+        class xmlAttributes
+        {
+            public:
+                /**\brief Construct with stream and object
+                 *
+                 * \param[out] pOut    The stream to write to.
+                 * \param[in]  pObject The object to write.
+                 */
+                xmlAttributes (efgy::render::oxmlstream<C> &pOut, const T &pObject)
+                    : out(pOut), object(pObject) {}
+
+                /**\brief Visit mandatory attribute field
+                 *
+                 * Writes the field as an XML attribute.
+                 *
+                 * \tparam V Type of the field.
+                 *
+                 * \param[in] label  Name of the XML attribute.
+                 * \param[in] member The field to write.
+                 */
+                template <typename V>
+                void attribute (const char *, const char *label, V T::*member)
+                {
+                    out.stream << " " << label << "='" << object.*member << "'";
+                }
+
+                /**\brief Visit optional attribute field
+                 *
+                 * Writes the field as an XML attribute, unless it is empty.
+                 * Partial ordering prefers this overload over the generic one
+                 * for all efgy::maybe fields.
+                 *
+                 * \tparam V Type of the field's value.
+                 *
+                 * \param[in] label  Name of the XML attribute.
+                 * \param[in] member The field to write.
+                 */
+                template <typename V>
+                void attribute (const char *, const char *label, efgy::maybe<V> T::*member)
+                {
+                    const efgy::maybe<V> &value = object.*member;
+                    if (value)
+                    {
+                        out.stream << " " << label << "='" << value.just << "'";
+                    }
+                }
+
+                /**\brief Visit content field
+                 *
+                 * Content fields are written by xmlContent, so this does
+                 * nothing.
+                 */
+                template <typename V>
+                void content (const char *, V T::*) {}
+
+            protected:
+                /**\brief Output stream
+                 *
+                 * The stream that was passed to the constructor.
+                 */
+                efgy::render::oxmlstream<C> &out;
+
+                /**\brief Object to write
+                 *
+                 * The object that was passed to the constructor.
+                 */
+                const T &object;
+        };
+
+        /**\brief XML content visitor
+         *
+         * Writes all of the content fields of an object that have a value as
+         * the text of the object's element; attribute fields are skipped. The
+         * start tag is closed with the first piece of content that is written,
+         * so 'open' tells whether a separate end tag is needed.
+         *
+         * \tparam C Character type of the stream.
+         * \tparam T The class of the object to write.
+         */
+        template <typename C, typename T>
+        class xmlContent
+        {
+            public:
+                /**\brief Construct with stream and object
+                 *
+                 * \param[out] pOut    The stream to write to.
+                 * \param[in]  pObject The object to write.
+                 */
+                xmlContent (efgy::render::oxmlstream<C> &pOut, const T &pObject)
+                    : open(false), out(pOut), object(pObject) {}
+
+                /**\brief Has the start tag been closed?
+                 *
+                 * Set to 'true' once any content has been written.
+                 */
+                bool open;
+
+                /**\brief Visit attribute field
+                 *
+                 * Attribute fields are written by xmlAttributes, so this does
+                 * nothing.
+                 */
+                template <typename V>
+                void attribute (const char *, const char *, V T::*) {}
+
+                /**\brief Visit mandatory content field
+                 *
+                 * Writes the field as text of the element.
+                 *
+                 * \tparam V Type of the field.
+                 *
+                 * \param[in] member The field to write.
+                 */
+                template <typename V>
+                void content (const char *, V T::*member)
+                {
+                    start();
+                    out.stream << object.*member;
+                }
+
+                /**\brief Visit optional content field
+                 *
+                 * Writes the field as text of the element, unless it is empty.
+                 * Partial ordering prefers this overload over the generic one
+                 * for all efgy::maybe fields.
+                 *
+                 * \tparam V Type of the field's value.
+                 *
+                 * \param[in] member The field to write.
+                 */
+                template <typename V>
+                void content (const char *, efgy::maybe<V> T::*member)
+                {
+                    const efgy::maybe<V> &value = object.*member;
+                    if (value)
+                    {
+                        start();
+                        out.stream << value.just;
+                    }
+                }
+
+            protected:
+                /**\brief Output stream
+                 *
+                 * The stream that was passed to the constructor.
+                 */
+                efgy::render::oxmlstream<C> &out;
+
+                /**\brief Object to write
+                 *
+                 * The object that was passed to the constructor.
+                 */
+                const T &object;
+
+                /**\brief Close start tag
+                 *
+                 * Writes the '>' that ends the start tag, unless that has
+                 * already happened.
+                 */
+                void start (void)
+                {
+                    if (!open)
+                    {
+                        out.stream << ">";
+                        open = true;
+                    }
+                }
+        };
+
+        /**\brief Column list for a class
+         *
+         * Runs the 'columns' visitor over the field description of T.
+         *
+         * \tparam T The class to generate the column list for.
+         *
+         * \returns The comma-separated list of T's columns.
+         */
+        template <typename T>
+        std::string list (void)
+        {
+            columns c;
+            T::fields(c);
+            return c.list;
+        }
+
+        /**\brief SELECT statement for a class
+         *
+         * Generates the statement that retrieves a single object of type T by
+         * its ID. The statement is generated the first time it is needed and
+         * then reused for all further instances of T.
+         *
+         * \tparam T The class to generate the statement for.
+         *
+         * \returns A statement of the form
+         *          "select <columns> from <table> where id=?1".
+         */
+        template <typename T>
+        const std::string &select (void)
+        {
+            static const std::string query = "select " + list<T>() + " from " + T::table() + " where id=?1";
+            return query;
+        }
+
+        /**\brief Database object with a field description
+         *
+         * Base class for database objects that are described with a fields()
+         * template. The SELECT statement for T is prepared once, when the
+         * object is constructed, and kept with the object; load() and sync()
+         * only rebind it. The statement is reset as soon as a row has been
+         * read, so that no read transaction stays open while the object is
+         * alive.
+         *
+         * Deriving classes need to call sync() in their constructor, as their
+         * fields are not yet initialised while this class is constructed.
+         *
+         * Since every instance owns a prepared statement, instances can not
+         * be copied; construct a new instance or use load() on an existing
+         * one instead.
+         *
+         * \tparam db The database access class to use, e.g.
+         *            efgy::database::sqlite
+         * \tparam T  The deriving class.
+         */
+        template <typename db, typename T>
+        class entity : public object<db>
+        {
+            public:
+                /**\copydoc object<db>::object
+                 *
+                 * Also prepares the SELECT statement for T, but does not
+                 * retrieve any data.
+                 */
+                entity (db &pDatabase, const typename db::id &pID)
+                    : object<db>(pDatabase, pID), query(select<T>(), pDatabase) {}
+
+                /**\brief Copying is not allowed
+                 *
+                 * The prepared statement can not be shared between instances.
+                 */
+                entity (const entity &) = delete;
+
+                /**\brief Copying is not allowed
+                 *
+                 * The prepared statement can not be shared between instances.
+                 */
+                entity &operator = (const entity &) = delete;
+
+                using object<db>::id;
+                using object<db>::valid;
+
+                /**\brief Retrieve a different object
+                 *
+                 * Changes the ID of the instance and retrieves the
+                 * corresponding row with the instance's prepared statement.
+                 * String fields are assigned with db::statement::get(), so
+                 * whether their buffers are reused is up to the database
+                 * class.
+                 *
+                 * \param[in] pID The ID that the instance should represent.
+                 *
+                 * \returns 'true' if the instance is now in a valid state,
+                 *          false otherwise.
+                 */
+                bool load (const typename db::id &pID)
+                {
+                    id = pID;
+                    return sync();
+                }
+
+            protected:
+                /**\brief Prepared SELECT statement
+                 *
+                 * The statement returned by select<T>(), prepared for the
+                 * database connection that the constructor was called with.
+                 */
+                typename db::statement query;
+
+                /**\brief Retrieve object data from database
+                 *
+                 * Selects the row identified by the object's ID from the
+                 * database and copies it into the object.
+                 *
+                 * \returns 'true' if the instance is now in a valid state,
+                 *          false otherwise.
+                 */
+                bool sync (void)
+                {
+                    query.bind(1, id);
+                    if (query.step() && query.row)
+                    {
+                        row<db,T> r(query, static_cast<T&>(*this));
+                        T::fields(r);
+                        query.reset();
+                        return (valid = true);
+                    }
+                    query.reset();
+                    return (valid = false);
+                }
+        };
+
+        /**\brief Serialise object to stream
+         *
+         * Writes an XML representation of an object to a C++ stream object:
+         * an element named after the class, with the object's ID and its
+         * attribute fields as XML attributes and its content fields as the
+         * element's text.
+         *
+         * \tparam C Character type of the stream.
+         * \tparam T The class of the object to write.
+         *
+         * \param[out] out The stream to write to.
+         * \param[in]  o   The object to write to the stream.
+         *
+         * \returns A reference to the 'out' parameter, as is customary with C++
+         *          streams.
+         */
+        template <typename C, typename T>
+        efgy::render::oxmlstream<C> xml (efgy::render::oxmlstream<C> out, const T &o)
+        {
+            if (!o.valid)
+            {
+                out.stream << "<" << T::element() << " id='" << o.id << "' status='invalid'/>";
+            }
+            else
+            {
+                out.stream << "<" << T::element() << " id='" << o.id << "'";
+                xmlAttributes<C,T> a(out, o);
+                T::fields(a);
+                xmlContent<C,T> c(out, o);
+                T::fields(c);
+                if (c.open)
+                {
+                    out.stream << "</" << T::element() << ">";
+                }
+                else
+                {
+                    out.stream << "/>";
+                }
+            }
+            return out;
+        }
+
+        /**\brief Serialise entity to stream
+         *
+         * Writes an XML representation of any class derived from entity to a
+         * C++ stream object; see xml().
+         *
+         * \tparam C  Character type of the stream.
+         * \tparam db Database type of the instance.
+         * \tparam T  The class of the object to write.
+         *
+         * \param[out] out The stream to write to.
+         * \param[in]  o   The object to write to the stream.
+         *
+         * \returns A reference to the 'out' parameter, as is customary with C++
+         *          streams.
+         */
+        template <typename C, typename db, typename T>
+        efgy::render::oxmlstream<C> operator << (efgy::render::oxmlstream<C> out, const entity<db,T> &o)
+        {
+            return xml(out, static_cast<const T&>(o));
+        }
+    };
+};
+
+#endif
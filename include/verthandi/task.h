@@ -32,9 +32,10 @@
 #if !defined(VERTHANDI_TASK_H)
 #define VERTHANDI_TASK_H
 
-#include <verthandi/object.h>
+#include <ef.gy/maybe.h>
+
+#include <verthandi/schema.h>
 
-#include <ostream>
 #include <string>
 
 namespace verthandi
@@ -42,13 +43,14 @@ namespace verthandi
     /**\brief A project-specific task
      *
      * Contains a single row of the 'tasks' table in the database. The row is
-     * identified by a numeric ID, which is why this class derives from the
-     * verthandi::object template.
+     * identified by a numeric ID and its columns are described by fields(),
+     * which is why this class derives from the verthandi::schema::entity
+     * template.
      *
      * \tparam db The database access class to use, e.g. efgy::database::sqlite
      */
     template <typename db>
-    class task : public object<db>
+    class task : public schema::entity<db,task<db>>
     {
         public:
             /**\copydoc object<db>::object
@@ -59,7 +61,7 @@ namespace verthandi
              * initialised.
              */
             task (db &pDatabase, const typename db::id &pID)
-                : object<db>(pDatabase, pID) { sync(); }
+                : schema::entity<db,task<db>>(pDatabase, pID) { this->sync(); }
 
             /**\brief Task title
              *
@@ -67,59 +69,110 @@ namespace verthandi
              */
             std::string title;
 
-            using object<db>::id;
-            using object<db>::valid;
+            /**\brief Project
+             *
+             * Corresponds to the tasks.project field in the database. This is
+             * the ID of a row in the 'projects' table.
+             */
+            efgy::maybe<typename db::id> projectID;
+
+            /**\brief Task description
+             *
+             * Corresponds to the tasks.description field in the database.
+             */
+            efgy::maybe<std::string> description;
+
+            /**\brief Urgency
+             *
+             * Corresponds to the tasks.urgency field in the database.
+             */
+            efgy::maybe<int> urgency;
+
+            /**\brief Importance
+             *
+             * Corresponds to the tasks.importance field in the database.
+             */
+            efgy::maybe<int> importance;
+
+            /**\brief Original time estimate
+             *
+             * Corresponds to the tasks.hours_estimated_orig field in the
+             * database. This is the estimate in hours.
+             */
+            efgy::maybe<double> hoursEstimatedOriginal;
 
-        protected:
-            using object<db>::database;
+            /**\brief Corrected time estimate
+             *
+             * Corresponds to the tasks.hours_estimated_corrected field in the
+             * database. The original estimate may be corrected while a task is
+             * being worked on.
+             */
+            efgy::maybe<double> hoursEstimatedCorrected;
 
-            /**\brief Retrieve task data from database
+            /**\brief Hourly rate
              *
-             * Selects the task's data from the database and stores the data in
-             * the class instance.
+             * Corresponds to the tasks.hourly_rate field in the database. The
+             * rate is given in units of 'currency'.
+             */
+            efgy::maybe<int> hourlyRate;
+
+            /**\brief Currency
+             *
+             * Corresponds to the tasks.currency field in the database. This is
+             * the currency that the hourly rate is given in.
+             */
+            efgy::maybe<std::string> currency;
+
+            /**\brief Progress
              *
-             * \returns 'true' if the task instance is now in a valid state,
-             *          false otherwise.
+             * Corresponds to the tasks.percentage_done field in the database.
              */
-            bool sync (void)
+            efgy::maybe<double> percentageDone;
+
+            /**\brief Is the task closed?
+             *
+             * Corresponds to the tasks.closed field in the database.
+             */
+            bool closed;
+
+            /**\brief Database table
+             *
+             * \returns The name of the table that tasks are stored in.
+             */
+            static const char *table (void) { return "tasks"; }
+
+            /**\brief XML element
+             *
+             * \returns The name of the XML element for a task.
+             */
+            static const char *element (void) { return "task"; }
+
+            /**\brief Field description
+             *
+             * Describes the columns of the 'tasks' table that are mapped to
+             * fields of this class; see verthandi::schema. The title is written
+             * to the 'name' attribute in XML.
+             *
+             * \tparam F Type of the visitor.
+             *
+             * \param[out] f The visitor to call for each field.
+             */
+            template <typename F>
+            static void fields (F &f)
             {
-                typename db::statement select("select title from tasks where id=?1", database);
-                select.bind(1, id);
-                if (select.step() && select.row)
-                {
-                    select.get(0, title);
-                    return (valid = true);
-                }
-                return (valid = false);
+                f.attribute("title",                     "name",                      &task::title);
+                f.attribute("project",                   "project",                   &task::projectID);
+                f.content  ("description",                                            &task::description);
+                f.attribute("urgency",                   "urgency",                   &task::urgency);
+                f.attribute("importance",                "importance",                &task::importance);
+                f.attribute("hours_estimated_orig",      "hours_estimated_orig",      &task::hoursEstimatedOriginal);
+                f.attribute("hours_estimated_corrected", "hours_estimated_corrected", &task::hoursEstimatedCorrected);
+                f.attribute("hourly_rate",               "hourly_rate",               &task::hourlyRate);
+                f.attribute("currency",                  "currency",                  &task::currency);
+                f.attribute("percentage_done",           "percentage_done",           &task::percentageDone);
+                f.attribute("closed",                    "closed",                    &task::closed);
             }
     };
-
-    /**\brief Serialise task to stream
-     *
-     * Writes an XML representation of a task to a C++ stream object.
-     *
-     * \tparam C  Character type of the stream.
-     * \tparam db Database type of the task instance.
-     *
-     * \param[out] out The stream to write to.
-     * \param[in]  p   The task instance to write to the stream.
-     *
-     * \returns A reference to the 'out' parameter, as is customary with C++
-     *          streams.
-     */
-    template <typename C, typename db>
-    efgy::render::oxmlstream<C> operator << (efgy::render::oxmlstream<C> out, const task<db> &p)
-    {
-        if (!p.valid)
-        {
-            out.stream << "<task id='" << p.id << "' status='invalid'/>";
-        }
-        else
-        {
-            out.stream << "<task id='" << p.id << "' name='" << p.title << "'/>";
-        }
-        return out;
-    }
 };
 
 #endif
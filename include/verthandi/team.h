@@ -0,0 +1,108 @@
+/**\file
+ * \brief Team abstraction
+ *
+ * Contains templates that provide access to teams in Verthandi's database. A
+ * team is a single entry in the 'teams' table.
+ *
+ * \copyright
+ * Copyright (c) 2013-2014, Verthandi Project Members
+ * \copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * \copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * \copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \see Project Documentation: http://ef.gy/documentation/verthandi
+ * \see Project Source Code: http://github.com/machinelady/verthandi.git
+ */
+
+#if !defined(VERTHANDI_TEAM_H)
+#define VERTHANDI_TEAM_H
+
+#include <ef.gy/maybe.h>
+
+#include <verthandi/schema.h>
+
+#include <string>
+
+namespace verthandi
+{
+    /**\brief A team
+     *
+     * Contains a single row of the 'teams' table in the database. The row is
+     * identified by a numeric ID and its columns are described by fields(),
+     * which is why this class derives from the verthandi::schema::entity
+     * template.
+     *
+     * \tparam db The database access class to use, e.g. efgy::database::sqlite
+     */
+    template <typename db>
+    class team : public schema::entity<db,team<db>>
+    {
+        public:
+            /**\copydoc object<db>::object
+             *
+             * In instances of the team type, the pID is assumed to refer to the
+             * contents of the teams.id column, and the corresponding row is
+             * automatically retrieved when an instance of the class is
+             * initialised.
+             */
+            team (db &pDatabase, const typename db::id &pID)
+                : schema::entity<db,team<db>>(pDatabase, pID) { this->sync(); }
+
+            /**\brief Team name
+             *
+             * Corresponds to the teams.name field in the database.
+             */
+            std::string name;
+
+            /**\brief Team description
+             *
+             * Corresponds to the teams.description field in the database.
+             */
+            efgy::maybe<std::string> description;
+
+            /**\brief Database table
+             *
+             * \returns The name of the table that teams are stored in.
+             */
+            static const char *table (void) { return "teams"; }
+
+            /**\brief XML element
+             *
+             * \returns The name of the XML element for a team.
+             */
+            static const char *element (void) { return "team"; }
+
+            /**\brief Field description
+             *
+             * Describes the columns of the 'teams' table that are mapped to
+             * fields of this class; see verthandi::schema.
+             *
+             * \tparam F Type of the visitor.
+             *
+             * \param[out] f The visitor to call for each field.
+             */
+            template <typename F>
+            static void fields (F &f)
+            {
+                f.attribute("name",        "name",        &team::name);
+                f.content  ("description",                &team::description);
+            }
+    };
+};
+
+#endif
@@ -0,0 +1,476 @@
+/**\file
+ * \brief Test cases for the declarative row mapping
+ *
+ * Loads the test fixture rows into a database that uses Verthandi's schema,
+ * and compares the generated statements, the field binding and the XML output
+ * of the classes in verthandi::schema with the expected values and with the
+ * original, hand-written code.
+ *
+ * \copyright
+ * Copyright (c) 2013-2014, Verthandi Project Members
+ * \copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * \copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * \copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * \see Project Documentation: http://ef.gy/documentation/verthandi
+ * \see Project Source Code: http://github.com/machinelady/verthandi.git
+ */
+
+
+#include <ef.gy/test-case.h>
+#include <ef.gy/sqlite.h>
+
+#include <verthandi/project.h>
+#include <verthandi/task.h>
+#include <verthandi/customer.h>
+#include <verthandi/collaborator.h>
+#include <verthandi/booking.h>
+#include <verthandi/team.h>
+#include <verthandi/data-sqlite-verthandi.h>
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace verthandi;
+using efgy::database::sqlite;
+
+/**\brief Create test database
+ *
+ * Creates the rows that the test cases expect in a database with Verthandi's
+ * schema:
+ *   - project 1 has all of its optional columns set except for the customer,
+ *     project 2 has none of them set, project 3 does not exist and project 4
+ *     refers to customer 1,
+ *   - task 1 has all of its optional columns set and is closed, task 2 has
+ *     none of them set and is open,
+ *   - customer 1 and team 1 have their content columns set.
+ *
+ * \param[out] sql The database to fill in.
+ */
+static void fixture (sqlite &sql)
+{
+    sqlite::statement
+        (  "insert into projects (id, name, description, deadline, urgency, importance)"
+           " values (1, 'verthandi', 'time tracking', 1394280000.5, 3, 4)", sql).step();
+    sqlite::statement
+        (  "insert into projects (id, name) values (2, 'norns')", sql).step();
+    sqlite::statement
+        (  "insert into projects (id, name, customer) values (4, 'skuld', 1)", sql).step();
+    sqlite::statement
+        (  "insert into tasks (id, project, title, description, urgency, importance,"
+           " hours_estimated_orig, hours_estimated_corrected, hourly_rate, currency,"
+           " percentage_done, closed)"
+           " values (1, 1, 'schema', 'row mapping', 2, 5, 8, 12.5, 50, 'EUR', 37.5, 1)", sql).step();
+    sqlite::statement
+        (  "insert into tasks (id, title, closed) values (2, 'bench', 0)", sql).step();
+    sqlite::statement
+        (  "insert into customers (id, name, primary_contact, primary_contact_email, notes)"
+           " values (1, 'acme', 'wile', 'wile@example.org', 'anvils')", sql).step();
+    sqlite::statement
+        (  "insert into teams (id, name, description) values (1, 'core', 'maintainers')", sql).step();
+}
+
+/**\brief Serialise to string
+ *
+ * \param[in] o The object to serialise.
+ *
+ * \returns The XML representation of the object.
+ */
+template <typename T>
+static std::string xml (const T &o)
+{
+    std::ostringstream s("");
+    s << efgy::render::XML() << o;
+    return s.str();
+}
+
+/**\brief Project, hand-written version
+ *
+ * A copy of the original project class, before it used the declarative row
+ * mapping. The test cases compare the new version with this one.
+ */
+class legacyProject
+{
+    public:
+        legacyProject (sqlite &database, const sqlite::id &pID)
+            : id(pID), valid(false)
+        {
+            sqlite::statement select("select name, description, deadline, urgency, importance from projects where id=?1", database);
+            select.bind(1, id);
+            if (select.step() && select.row)
+            {
+                select.get(0, name);
+                description.nothing = !select.get(1, description.just);
+                deadline.nothing    = !select.get(2, deadline.just);
+                urgency.nothing     = !select.get(3, urgency.just);
+                importance.nothing  = !select.get(4, importance.just);
+                valid = true;
+            }
+        }
+
+        sqlite::id id;
+        bool valid;
+        std::string name;
+        efgy::maybe<std::string> description;
+        efgy::maybe<double> deadline;
+        efgy::maybe<int> urgency;
+        efgy::maybe<int> importance;
+};
+
+/**\brief Serialise project to stream, hand-written version
+ *
+ * A copy of the original operator << for projects.
+ */
+template <typename C>
+efgy::render::oxmlstream<C> operator << (efgy::render::oxmlstream<C> out, const legacyProject &p)
+{
+    if (!p.valid)
+    {
+        out.stream << "<project id='" << p.id << "' status='invalid'/>";
+    }
+    else
+    {
+        out.stream << "<project id='" << p.id << "' name='" << p.name << "'";
+        if (p.deadline)
+        {
+            out.stream << " deadline='" << p.deadline.just << "'";
+        }
+        if (p.urgency)
+        {
+            out.stream << " urgency='" << p.urgency.just << "'";
+        }
+        if (p.importance)
+        {
+            out.stream << " importance='" << p.importance.just << "'";
+        }
+        if (p.description)
+        {
+            out.stream << ">" << p.description.just << "</project>";
+        }
+        else
+        {
+            out.stream << "/>";
+        }
+    }
+    return out;
+}
+
+/**\brief Compare two optional values
+ *
+ * \param[in] a The first value.
+ * \param[in] b The second value.
+ *
+ * \returns 'true' if both values are empty, or if both have the same value.
+ */
+template <typename T>
+static bool same (const efgy::maybe<T> &a, const efgy::maybe<T> &b)
+{
+    return (bool)a == (bool)b && (!a || a.just == b.just);
+}
+
+/**\brief Test generated SELECT statements
+ *
+ * Compares the statements that verthandi::schema::select() generates for each
+ * of the database classes with the expected SQL.
+ *
+ * \param[out] log A stream for test cases to log messages to.
+ *
+ * \returns Zero when everything went as expected, nonzero otherwise.
+ */
+int testSelect (std::ostream &log)
+{
+    struct { const std::string &actual; const char *expected; } queries[] =
+    {
+        { schema::select<project<sqlite>>(),
+          "select name, description, customer, deadline, urgency, importance from projects where id=?1" },
+        { schema::select<task<sqlite>>(),
+          "select title, project, description, urgency, importance, hours_estimated_orig, hours_estimated_corrected, hourly_rate, currency, percentage_done, closed from tasks where id=?1" },
+        { schema::select<customer<sqlite>>(),
+          "select name, primary_contact, primary_contact_email, primary_contact_phone, notes from customers where id=?1" },
+        { schema::select<collaborator<sqlite>>(),
+          "select first_name, last_name, email, phone, form_of_address, preferred_pronoun from collaborators where id=?1" },
+        { schema::select<booking<sqlite>>(),
+          "select start_time, end_time from bookings where id=?1" },
+        { schema::select<team<sqlite>>(),
+          "select name, description from teams where id=?1" }
+    };
+
+    for (const auto &q : queries)
+    {
+        if (q.actual != q.expected)
+        {
+            log << "unexpected statement: '" << q.actual << "', expected '" << q.expected << "'\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**\brief Test NULL handling
+ *
+ * Loads projects with and without NULL columns into the same instance, and
+ * verifies that the efgy::maybe fields are set and cleared accordingly.
+ *
+ * \param[out] log A stream for test cases to log messages to.
+ *
+ * \returns Zero when everything went as expected, nonzero otherwise.
+ */
+int testNull (std::ostream &log)
+{
+    sqlite sql(":memory:", data::sqlite::verthandi);
+    fixture(sql);
+
+    project<sqlite> p(sql, 1);
+
+    if (!p.valid || p.name != "verthandi" || !p.description || !p.deadline
+     || !p.urgency || !p.importance || p.customerID)
+    {
+        log << "project 1 was not loaded correctly\n";
+        return 1;
+    }
+
+    if (!p.load(2) || p.name != "norns" || p.description || p.deadline
+     || p.urgency || p.importance || p.customerID)
+    {
+        log << "project 2 was not loaded correctly over project 1\n";
+        return 2;
+    }
+
+    if (!p.load(1) || p.name != "verthandi" || !p.description
+     || p.description.just != "time tracking" || !p.deadline
+     || p.deadline.just != 1394280000.5 || !p.urgency || p.urgency.just != 3
+     || !p.importance || p.importance.just != 4)
+    {
+        log << "project 1 was not loaded correctly over project 2\n";
+        return 3;
+    }
+
+    if (p.load(3) || p.valid)
+    {
+        log << "project 3 does not exist, but was loaded\n";
+        return 4;
+    }
+
+    return 0;
+}
+
+/**\brief Compare with hand-written code
+ *
+ * Loads each of the fixture projects, and a project that does not exist, both
+ * with the project class and with the original, hand-written version of it,
+ * and verifies that both contain the same data and produce byte-identical
+ * XML.
+ *
+ * \param[out] log A stream for test cases to log messages to.
+ *
+ * \returns Zero when everything went as expected, nonzero otherwise.
+ */
+int testLegacy (std::ostream &log)
+{
+    sqlite sql(":memory:", data::sqlite::verthandi);
+    fixture(sql);
+
+    project<sqlite> p(sql, 1);
+
+    for (sqlite::id id = 1; id <= 3; id++)
+    {
+        legacyProject l(sql, id);
+        p.load(id);
+
+        if (p.valid != l.valid || (p.valid
+             && (p.name != l.name || !same(p.description, l.description)
+              || !same(p.deadline, l.deadline) || !same(p.urgency, l.urgency)
+              || !same(p.importance, l.importance))))
+        {
+            log << "project " << id << " differs from the hand-written version\n";
+            return 1;
+        }
+
+        std::ostringstream ps(""), ls("");
+        ps << efgy::render::XML() << p;
+        ls << efgy::render::XML() << l;
+
+        if (ps.str() != ls.str())
+        {
+            log << "unexpected XML: '" << ps.str() << "', expected '" << ls.str() << "'\n";
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+/**\brief Test task mapping
+ *
+ * Loads tasks with and without NULL columns into the same instance, and
+ * verifies the loaded values, including the 'closed' flag, the 'numeric'
+ * columns and the project reference, as well as the exact XML output.
+ *
+ * \param[out] log A stream for test cases to log messages to.
+ *
+ * \returns Zero when everything went as expected, nonzero otherwise.
+ */
+int testTask (std::ostream &log)
+{
+    sqlite sql(":memory:", data::sqlite::verthandi);
+    fixture(sql);
+
+    task<sqlite> t(sql, 2);
+
+    if (!t.valid || t.title != "bench" || t.closed || t.projectID
+     || t.description || t.urgency || t.importance || t.hoursEstimatedOriginal
+     || t.hoursEstimatedCorrected || t.hourlyRate || t.currency
+     || t.percentageDone)
+    {
+        log << "task 2 was not loaded correctly\n";
+        return 1;
+    }
+
+    std::string x = xml(t);
+    if (x != "<task id='2' name='bench' closed='0'/>")
+    {
+        log << "unexpected XML for task 2: '" << x << "'\n";
+        return 2;
+    }
+
+    if (!t.load(1) || t.title != "schema" || !t.closed
+     || !t.projectID || t.projectID.just != 1
+     || !t.description || t.description.just != "row mapping"
+     || !t.urgency || t.urgency.just != 2
+     || !t.importance || t.importance.just != 5
+     || !t.hoursEstimatedOriginal || t.hoursEstimatedOriginal.just != 8
+     || !t.hoursEstimatedCorrected || t.hoursEstimatedCorrected.just != 12.5
+     || !t.hourlyRate || t.hourlyRate.just != 50
+     || !t.currency || t.currency.just != "EUR"
+     || !t.percentageDone || t.percentageDone.just != 37.5)
+    {
+        log << "task 1 was not loaded correctly over task 2\n";
+        return 3;
+    }
+
+    x = xml(t);
+    if (x != "<task id='1' name='schema' project='1' urgency='2' importance='5'"
+             " hours_estimated_orig='8' hours_estimated_corrected='12.5'"
+             " hourly_rate='50' currency='EUR' percentage_done='37.5'"
+             " closed='1'>row mapping</task>")
+    {
+        log << "unexpected XML for task 1: '" << x << "'\n";
+        return 4;
+    }
+
+    if (!t.load(2) || t.closed || t.projectID || t.description
+     || t.hoursEstimatedOriginal || t.percentageDone)
+    {
+        log << "task 2 was not loaded correctly over task 1\n";
+        return 5;
+    }
+
+    return 0;
+}
+
+/**\brief Test content fields and references
+ *
+ * Verifies the XML output of classes with content fields, and that a project
+ * that refers to a customer gets the additional 'customer' attribute.
+ *
+ * \param[out] log A stream for test cases to log messages to.
+ *
+ * \returns Zero when everything went as expected, nonzero otherwise.
+ */
+int testContent (std::ostream &log)
+{
+    sqlite sql(":memory:", data::sqlite::verthandi);
+    fixture(sql);
+
+    struct { std::string actual; const char *expected; } outputs[] =
+    {
+        { xml(customer<sqlite>(sql, 1)),
+          "<customer id='1' name='acme' primary_contact='wile'"
+          " primary_contact_email='wile@example.org'>anvils</customer>" },
+        { xml(team<sqlite>(sql, 1)),
+          "<team id='1' name='core'>maintainers</team>" },
+        { xml(team<sqlite>(sql, 2)),
+          "<team id='2' status='invalid'/>" },
+        { xml(project<sqlite>(sql, 4)),
+          "<project id='4' name='skuld' customer='1'/>" }
+    };
+
+    for (const auto &o : outputs)
+    {
+        if (o.actual != o.expected)
+        {
+            log << "unexpected XML: '" << o.actual << "', expected '" << o.expected << "'\n";
+            return 1;
+        }
+    }
+
+    project<sqlite> p(sql, 4);
+    if (!p.customerID || p.customerID.just != 1)
+    {
+        log << "project 4 does not refer to customer 1\n";
+        return 2;
+    }
+
+    return 0;
+}
+
+/**\brief Test locking
+ *
+ * Verifies that an instance does not keep a read transaction open after it
+ * has been loaded, by writing to the database through a second connection
+ * while the instance is still alive.
+ *
+ * \param[out] log A stream for test cases to log messages to.
+ *
+ * \returns Zero when everything went as expected, nonzero otherwise.
+ */
+int testLock (std::ostream &log)
+{
+    static const char file[] = "test-case-schema.sqlite3";
+    std::remove(file);
+
+    int rv = 0;
+
+    {
+        sqlite reader(file, data::sqlite::verthandi);
+        fixture(reader);
+        sqlite writer(file, "");
+
+        project<sqlite> p(reader, 1);
+
+        sqlite::statement insert("insert into teams (id, name) values (2, 'lock')", writer);
+        if (!p.valid || !insert.step())
+        {
+            log << "could not write while a project instance was alive\n";
+            rv = 1;
+        }
+    }
+
+    std::remove(file);
+    return rv;
+}
+
+TEST_BATCH(testSelect)
+TEST_BATCH(testNull)
+TEST_BATCH(testLegacy)
+TEST_BATCH(testTask)
+TEST_BATCH(testContent)
+TEST_BATCH(testLock)